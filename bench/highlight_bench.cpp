@@ -0,0 +1,183 @@
+#include "transpiler.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+// Measures the cost of code block highlighting against the plain escaping
+// path, both in isolation and as part of a full transpile.
+//
+// Usage: highlight-bench [iterations]
+
+namespace {
+
+struct Sample {
+    const char* name;
+    HighlightLanguage language;
+    const char* snippet;
+};
+
+const Sample samples[] = {
+    {"cpp", HighlightLanguage::CPP,
+     "#include <vector>\n"
+     "// Sum the even entries\n"
+     "template <typename T>\n"
+     "static T sumEven(const std::vector<T>& values) {\n"
+     "    T total = 0; /* running total */\n"
+     "    for (size_t i = 0; i < values.size(); ++i) {\n"
+     "        if (values[i] % 2 == 0 && values[i] > 0x10) total += values[i] * 2.5e-3;\n"
+     "    }\n"
+     "    return total != 0 ? total : static_cast<T>(nullptr == 0);\n"
+     "}\n"},
+    {"python", HighlightLanguage::PYTHON,
+     "# Sum the even entries\n"
+     "def sum_even(values, scale=2.5e-3):\n"
+     "    \"\"\"Return the scaled sum of even values.\"\"\"\n"
+     "    total = 0\n"
+     "    for value in values:\n"
+     "        if value % 2 == 0 and value is not None:\n"
+     "            total += value * scale\n"
+     "    return total if total else 'empty' + str(True)\n"},
+    {"json", HighlightLanguage::JSON,
+     "{\n"
+     "    \"name\": \"transpiler\", \"version\": 3, \"ratio\": -1.5e-3,\n"
+     "    \"enabled\": true, \"parent\": null,\n"
+     "    \"tags\": [\"markdown\", \"html\", \"<fast>\"],\n"
+     "    \"limits\": {\"depth\": 64, \"width\": 1024}\n"
+     "}\n"},
+    {"shell", HighlightLanguage::SHELL,
+     "#!/bin/bash\n"
+     "# Convert every document\n"
+     "for file in \"$@\"; do\n"
+     "    if [ -f \"${file}\" ]; then\n"
+     "        ./markdown-transpiler \"$file\" \"${file%.md}.html\" && echo ok # done\n"
+     "    fi\n"
+     "done\n"
+     "exit $?\n"},
+};
+
+const size_t TARGET_SIZE = 1 << 20;
+
+std::string repeatToSize(const std::string& snippet, size_t size) {
+    std::string text;
+    text.reserve(size + snippet.size());
+    while (text.size() < size) {
+        text += snippet;
+    }
+    return text;
+}
+
+// Returns the best wall time of 'iterations' runs in milliseconds
+template <typename Fn>
+double bestOf(int iterations, Fn fn) {
+    double best = 0;
+    for (int i = 0; i < iterations; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        auto end = std::chrono::steady_clock::now();
+        double elapsed = std::chrono::duration<double, std::milli>(end - start).count();
+        if (i == 0 || elapsed < best) {
+            best = elapsed;
+        }
+    }
+    return best;
+}
+
+double megabytesPerSecond(size_t bytes, double ms) {
+    return (bytes / (1024.0 * 1024.0)) / (ms / 1000.0);
+}
+
+// Builds a Markdown document made of fenced blocks in every sample language
+std::vector<std::string> buildDocument(bool tagged, int blocks) {
+    std::vector<std::string> lines;
+    for (int i = 0; i < blocks; ++i) {
+        const Sample& sample = samples[i % (sizeof(samples) / sizeof(samples[0]))];
+        lines.push_back("## Example " + std::to_string(i));
+        lines.push_back("");
+        lines.push_back(std::string("```") + (tagged ? sample.name : ""));
+        std::string snippet = sample.snippet;
+        size_t pos = 0;
+        while (pos < snippet.size()) {
+            size_t end = snippet.find('\n', pos);
+            lines.push_back(snippet.substr(pos, end - pos));
+            pos = end + 1;
+        }
+        lines.push_back("```");
+        lines.push_back("");
+    }
+    return lines;
+}
+
+size_t transpile(const std::vector<std::string>& lines) {
+    Lexer lexer;
+    lexer.setInput(lines);
+    
+    std::vector<Token> tokens;
+    while (lexer.hasMoreTokens()) {
+        tokens.push_back(lexer.getNextToken());
+    }
+    
+    Parser parser;
+    parser.setTokens(tokens);
+    auto root = parser.parse();
+    
+    Generator generator;
+    OutputVector output;
+    generator.generateHTML(*root, output);
+    return output.size();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int iterations = (argc > 1) ? std::atoi(argv[1]) : 10;
+    if (iterations < 1) {
+        iterations = 1;
+    }
+    
+    Highlighter highlighter;
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "Highlighter vs escape-only, " << (TARGET_SIZE >> 10) << " KiB per language, best of "
+              << iterations << std::endl;
+    std::cout << std::left << std::setw(8) << "lang" << std::right
+              << std::setw(14) << "escape MB/s" << std::setw(17) << "highlight MB/s"
+              << std::setw(12) << "slowdown" << std::endl;
+    
+    for (const auto& sample : samples) {
+        std::string code = repeatToSize(sample.snippet, TARGET_SIZE);
+        std::string out;
+        out.reserve(code.size() * 4);
+        
+        double escape_ms = bestOf(iterations, [&] {
+            out.clear();
+            appendEscapedHTML(out, code, 0, code.size());
+        });
+        double highlight_ms = bestOf(iterations, [&] {
+            out.clear();
+            highlighter.highlight(sample.language, code, out);
+        });
+        
+        std::cout << std::left << std::setw(8) << sample.name << std::right
+                  << std::setw(14) << megabytesPerSecond(code.size(), escape_ms)
+                  << std::setw(17) << megabytesPerSecond(code.size(), highlight_ms)
+                  << std::setw(11) << highlight_ms / escape_ms << "x" << std::endl;
+    }
+    
+    // End to end: the same document with untagged and tagged fences
+    const int blocks = 4000;
+    auto plain_doc = buildDocument(false, blocks);
+    auto tagged_doc = buildDocument(true, blocks);
+    
+    size_t plain_size = 0;
+    size_t tagged_size = 0;
+    double plain_ms = bestOf(iterations, [&] { plain_size = transpile(plain_doc); });
+    double tagged_ms = bestOf(iterations, [&] { tagged_size = transpile(tagged_doc); });
+    
+    std::cout << std::endl;
+    std::cout << "Full transpile, " << blocks << " fenced blocks" << std::endl;
+    std::cout << "  plain fences:  " << plain_ms << " ms (" << (plain_size >> 10) << " KiB out)" << std::endl;
+    std::cout << "  tagged fences: " << tagged_ms << " ms (" << (tagged_size >> 10) << " KiB out)" << std::endl;
+    std::cout << "  overhead:      " << (tagged_ms / plain_ms - 1.0) * 100.0 << "%" << std::endl;
+    
+    return 0;
+}
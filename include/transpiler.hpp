@@ -5,6 +5,8 @@
 #include <vector>
 #include <memory>
 #include <regex>
+#include <deque>
+#include <set>
 
 // Token types for the lexer
 enum class TokenType {
@@ -37,6 +39,8 @@ struct Token {
 struct Element {
     std::string tag;                    // HTML tag name
     std::string content;                // Text content
+    std::string plain_text;             // Headings: text without inline markup
+    std::string id;                     // Headings: unique anchor for TOC links
     std::vector<std::string> attributes; // HTML attributes
     std::vector<std::shared_ptr<Element>> children; // Nested elements
     
@@ -58,6 +62,7 @@ private:
     std::vector<std::string> lines;
     size_t current_line;
     size_t current_pos;
+    bool in_code_block;     // Inside a ``` fence, lines are passed through verbatim
     
     // Regex patterns
     std::regex header_pattern;
@@ -88,6 +93,8 @@ class Parser {
 private:
     std::vector<Token> tokens;
     size_t current_token;
+    std::set<std::string> used_ids;     // Heading ids already assigned in this parse
+    size_t heading_count;
     
 public:
     Parser();
@@ -102,28 +109,154 @@ private:
     std::shared_ptr<Element> parseParagraph();
     std::shared_ptr<Element> parseCodeBlock();
     std::shared_ptr<Element> parseInlineElements(const std::string& text);
+    std::string stripInlineMarkup(const std::string& text);
+    std::string uniqueHeadingId(const std::string& text);
     Token peek() const;
     Token consume();
     bool match(TokenType type) const;
     bool isAtEnd() const;
 };
 
+// Languages supported by the code block highlighter
+enum class HighlightLanguage {
+    NONE,           // No highlighting, plain escaped text
+    CPP,            // cpp, cxx, cc, c, hpp, h
+    PYTHON,         // python, py, python3
+    JSON,           // json
+    SHELL           // sh, bash, shell, zsh
+};
+
+// Highlighter class
+// Scans fenced code block content with precompiled per-language tables
+// (character classes and sorted keyword lists) and emits escaped HTML with
+// <span class="hl-..."> markup around keywords, strings, numbers and comments.
+class Highlighter {
+public:
+    static HighlightLanguage languageFromName(const std::string& name);
+    void highlight(HighlightLanguage language, const std::string& code, std::string& out) const;
+};
+
+// Scatter-gather output buffer
+// Collects (pointer, length) entries for writev. Runs of at least
+// COPY_THRESHOLD bytes are referenced in place, so long text from the element
+// tree is copied only once, by writev itself. Shorter fragments such as tags
+// and entities are packed into owned chunks so they share a single entry.
+class OutputVector {
+public:
+    struct Entry {
+        const char* data;
+        size_t length;
+    };
+    
+    static const size_t COPY_THRESHOLD = 64;
+    static const size_t CHUNK_SIZE = 16 * 1024;
+    
+private:
+    std::vector<Entry> entries;
+    std::deque<std::string> owned;      // Deque keeps fragment addresses stable
+    std::string* chunk;                 // Owned chunk that short fragments are copied into
+    size_t total_size;
+    
+public:
+    OutputVector();
+    OutputVector(const OutputVector&) = delete;
+    OutputVector& operator=(const OutputVector&) = delete;
+    
+    void append(const char* data, size_t length);   // Caller keeps data alive
+    void append(const std::string& text);           // Caller keeps text alive
+    void append(std::string&& text) = delete;       // Temporaries must use appendOwned
+    void appendOwned(std::string text);
+    
+    template <size_t N>
+    void appendLiteral(const char (&literal)[N]) {
+        append(literal, N - 1);
+    }
+    
+    const std::vector<Entry>& getEntries() const { return entries; }
+    size_t size() const { return total_size; }
+    void reset();
+    
+private:
+    void copyIntoChunk(const char* data, size_t length);
+};
+
 // Generator class
 class Generator {
+private:
+    Highlighter highlighter;
+    bool heading_ids;       // Emit heading id attributes for TOC links
+    
 public:
     Generator();
+    void setHeadingIds(bool enabled);
     std::string generateHTML(const std::shared_ptr<Element>& root);
     std::string generateHTML(const Element& element);
+    void generateHTML(const Element& element, OutputVector& out);
+    std::string generateTOC(const Element& root);
+    std::string findTitle(const Element& root);
     
 private:
     std::string escapeHTML(const std::string& text);
-    std::string generateAttributes(const std::vector<std::string>& attributes);
+    void appendEscaped(OutputVector& out, const std::string& text);
+    HighlightLanguage codeLanguage(const Element& element) const;
+};
+
+// Values substituted into the slots of a page template
+// The strings are referenced, not copied, so they must outlive the output.
+struct PageContent {
+    std::string title;      // Plain text, escaped when rendered
+    std::string css;        // Stylesheet rules
+    std::string toc;        // Table of contents HTML
+    const Element* body;    // Streamed into the body slot by the generator
+    
+    PageContent() : body(nullptr) {}
+};
+
+// Page template class
+// A template is compiled once into literal segments and {{slot}} references
+// and can then render any number of documents.
+class PageTemplate {
+public:
+    enum class Slot {
+        NONE,           // Literal text segment
+        TITLE,          // {{title}}
+        CSS,            // {{css}}
+        TOC,            // {{toc}}
+        BODY            // {{body}}
+    };
+    
+    struct Segment {
+        Slot slot;
+        std::string text;   // Literal text when slot is NONE
+        
+        Segment(Slot s, const std::string& t = "") : slot(s), text(t) {}
+    };
+    
+private:
+    std::vector<Segment> segments;
+    
+public:
+    PageTemplate();
+    bool compile(const std::string& source);
+    bool loadFromFile(const std::string& filename);
+    bool hasSlot(Slot slot) const;
+    void render(const PageContent& content, Generator& generator, OutputVector& out) const;
+    
+    static const char* defaultCSS();
+    
+private:
+    void addLiteral(const std::string& text);
+    static bool slotFromName(const std::string& name, Slot& slot);
 };
 
 // Utility functions
 std::vector<std::string> readLinesFromFile(const std::string& filename);
-void writeToFile(const std::string& filename, const std::string& content);
+bool readFileContents(const std::string& filename, std::string& content);
+bool writeToFile(const std::string& filename, const std::string& content);
+bool writeToFile(const std::string& filename, const OutputVector& output);
 std::string trim(const std::string& str);
+void appendEscapedHTML(std::string& out, const std::string& text, size_t begin, size_t end);
 bool startsWith(const std::string& str, const std::string& prefix);
+std::string slugify(const std::string& text);
 
 #endif // TRANSPILER_HPP 
\ No newline at end of file
@@ -1,72 +1,205 @@
 #include "transpiler.hpp"
 #include <sstream>
 #include <algorithm>
+#include <string_view>
 
-Generator::Generator() {}
+// Precomposed tags for the elements the parser produces
+struct TagLiterals {
+    std::string_view name;
+    std::string_view open;      // Used when the element has no attributes
+    std::string_view close;     // Empty for self-closing tags
+};
+
+static const TagLiterals TAG_LITERALS[] = {
+    {"div", "<div>", "</div>"},
+    {"p", "<p>", "</p>"},
+    {"span", "<span>", "</span>"},
+    {"h1", "<h1>", "</h1>"},
+    {"h2", "<h2>", "</h2>"},
+    {"h3", "<h3>", "</h3>"},
+    {"h4", "<h4>", "</h4>"},
+    {"h5", "<h5>", "</h5>"},
+    {"h6", "<h6>", "</h6>"},
+    {"ul", "<ul>", "</ul>"},
+    {"li", "<li>", "</li>"},
+    {"pre", "<pre>", "</pre>"},
+    {"code", "<code>", "</code>"},
+    {"hr", "<hr>", ""},
+    {"img", "<img>", ""}
+};
+
+static const TagLiterals* findTagLiterals(const std::string& tag) {
+    for (const auto& literals : TAG_LITERALS) {
+        if (literals.name == tag) {
+            return &literals;
+        }
+    }
+    return nullptr;
+}
+
+Generator::Generator() : heading_ids(false) {}
+
+void Generator::setHeadingIds(bool enabled) {
+    heading_ids = enabled;
+}
 
 std::string Generator::generateHTML(const std::shared_ptr<Element>& root) {
     return generateHTML(*root);
 }
 
 std::string Generator::generateHTML(const Element& element) {
-    std::ostringstream out;
+    // Same element walk as the scatter-gather path, flattened into one string
+    OutputVector out;
+    generateHTML(element, out);
     
-    // Handle self-closing tags
-    if (element.tag == "hr" || element.tag == "img") {
-        out << "<" << element.tag;
-        if (!element.attributes.empty()) {
-            out << " " << generateAttributes(element.attributes);
+    std::string html;
+    html.reserve(out.size());
+    for (const auto& entry : out.getEntries()) {
+        html.append(entry.data, entry.length);
+    }
+    return html;
+}
+
+void Generator::generateHTML(const Element& element, OutputVector& out) {
+    const TagLiterals* literals = findTagLiterals(element.tag);
+    
+    const bool with_id = heading_ids && !element.id.empty();
+    
+    // Opening tag, shared by self-closing tags
+    if (literals && element.attributes.empty() && !with_id) {
+        out.append(literals->open.data(), literals->open.size());
+    } else {
+        out.appendLiteral("<");
+        out.append(element.tag);
+        if (with_id) {
+            out.appendLiteral(" id=\"");
+            out.append(element.id);
+            out.appendLiteral("\"");
+        }
+        for (const auto& attribute : element.attributes) {
+            out.appendLiteral(" ");
+            out.append(attribute);
         }
-        out << ">";
-        return out.str();
+        out.appendLiteral(">");
     }
     
-    // Opening tag
-    out << "<" << element.tag;
-    if (!element.attributes.empty()) {
-        out << " " << generateAttributes(element.attributes);
+    if (element.tag == "hr" || element.tag == "img") {
+        return;
     }
-    out << ">";
     
     // Content and children
     if (!element.children.empty()) {
         for (const auto& child : element.children) {
-            out << generateHTML(child);
+            generateHTML(*child, out);
         }
     } else if (!element.content.empty()) {
-        out << escapeHTML(element.content);
+        HighlightLanguage language = codeLanguage(element);
+        if (language != HighlightLanguage::NONE) {
+            std::string highlighted;
+            highlighted.reserve(element.content.size() * 2);
+            highlighter.highlight(language, element.content, highlighted);
+            out.appendOwned(std::move(highlighted));
+        } else {
+            appendEscaped(out, element.content);
+        }
     }
     
     // Closing tag
-    out << "</" << element.tag << ">";
+    if (literals) {
+        out.append(literals->close.data(), literals->close.size());
+    } else {
+        out.appendLiteral("</");
+        out.append(element.tag);
+        out.appendLiteral(">");
+    }
+}
+
+std::string Generator::generateTOC(const Element& root) {
+    std::ostringstream out;
+    out << "<ul class=\"toc\">";
+    
+    for (const auto& child : root.children) {
+        const Element& heading = *child;
+        if (heading.tag.length() != 2 || heading.tag[0] != 'h' || heading.tag[1] < '1' || heading.tag[1] > '6') {
+            continue;
+        }
+        
+        out << "<li class=\"toc-" << heading.tag << "\"><a href=\"#" << heading.id << "\">"
+            << escapeHTML(heading.plain_text) << "</a></li>";
+    }
     
+    out << "</ul>";
     return out.str();
 }
 
+std::string Generator::findTitle(const Element& root) {
+    for (const auto& child : root.children) {
+        if (child->tag == "h1") {
+            return child->plain_text;
+        }
+    }
+    return "";
+}
+
 std::string Generator::escapeHTML(const std::string& text) {
     std::string result;
-    for (char c : text) {
-        switch (c) {
-            case '&': result += "&amp;"; break;
-            case '<': result += "&lt;"; break;
-            case '>': result += "&gt;"; break;
-            case '"': result += "&quot;"; break;
-            case '\'': result += "&#39;"; break;
-            default: result += c; break;
+    appendEscapedHTML(result, text, 0, text.size());
+    return result;
+}
+
+void Generator::appendEscaped(OutputVector& out, const std::string& text) {
+    // Clean runs point straight into the element text; entities are literals
+    size_t run_start = 0;
+    for (size_t i = 0; i < text.size(); ++i) {
+        switch (text[i]) {
+            case '&':
+            case '<':
+            case '>':
+            case '"':
+            case '\'':
+                break;
+            default:
+                continue;
         }
+        out.append(text.data() + run_start, i - run_start);
+        switch (text[i]) {
+            case '&': out.appendLiteral("&amp;"); break;
+            case '<': out.appendLiteral("&lt;"); break;
+            case '>': out.appendLiteral("&gt;"); break;
+            case '"': out.appendLiteral("&quot;"); break;
+            default: out.appendLiteral("&#39;"); break;
+        }
+        run_start = i + 1;
     }
-    return result;
+    out.append(text.data() + run_start, text.size() - run_start);
 }
 
-std::string Generator::generateAttributes(const std::vector<std::string>& attributes) {
-    std::ostringstream out;
+HighlightLanguage Generator::codeLanguage(const Element& element) const {
+    if (element.tag != "code") {
+        return HighlightLanguage::NONE;
+    }
     
-    for (size_t i = 0; i < attributes.size(); ++i) {
-        if (i > 0) {
-            out << " ";
+    // The parser tags fenced blocks with class="language-<info string>"
+    const std::string prefix = "class=\"language-";
+    for (const auto& attribute : element.attributes) {
+        if (startsWith(attribute, prefix) && attribute.back() == '"') {
+            std::string name = attribute.substr(prefix.length(), attribute.length() - prefix.length() - 1);
+            return Highlighter::languageFromName(name);
         }
-        out << attributes[i];
     }
     
-    return out.str();
-} 
\ No newline at end of file
+    return HighlightLanguage::NONE;
+}
+
+void appendEscapedHTML(std::string& out, const std::string& text, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+        switch (text[i]) {
+            case '&': out += "&amp;"; break;
+            case '<': out += "&lt;"; break;
+            case '>': out += "&gt;"; break;
+            case '"': out += "&quot;"; break;
+            case '\'': out += "&#39;"; break;
+            default: out += text[i]; break;
+        }
+    }
+}
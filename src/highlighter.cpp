@@ -0,0 +1,375 @@
+#include "transpiler.hpp"
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <string_view>
+
+namespace {
+
+// Character class bits used by the scanner tables
+enum CharClass : unsigned char {
+    CC_SPACE       = 1 << 0,   // Whitespace
+    CC_IDENT_START = 1 << 1,   // May start an identifier or keyword
+    CC_IDENT       = 1 << 2,   // May continue an identifier or keyword
+    CC_DIGIT       = 1 << 3,   // Starts a number
+    CC_QUOTE       = 1 << 4,   // Opens a string literal
+    CC_COMMENT     = 1 << 5,   // First byte of a comment opener
+    CC_SIGIL       = 1 << 6    // '#' directive (C++) or '$' variable (shell)
+};
+
+using CharTable = std::array<unsigned char, 256>;
+
+constexpr CharTable buildCharTable(const char* quotes, const char* comment_starts,
+                                   const char* sigils, const char* extra_ident) {
+    CharTable table{};
+    for (int c = 0; c < 256; ++c) {
+        unsigned char cls = 0;
+        if (c == ' ' || c == '\t' || c == '\n' || c == '\r') {
+            cls |= CC_SPACE;
+        }
+        if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_') {
+            cls |= CC_IDENT_START | CC_IDENT;
+        }
+        if (c >= '0' && c <= '9') {
+            cls |= CC_DIGIT | CC_IDENT;
+        }
+        table[c] = cls;
+    }
+    for (const char* p = quotes; *p; ++p) {
+        table[static_cast<unsigned char>(*p)] |= CC_QUOTE;
+    }
+    for (const char* p = comment_starts; *p; ++p) {
+        table[static_cast<unsigned char>(*p)] |= CC_COMMENT;
+    }
+    for (const char* p = sigils; *p; ++p) {
+        table[static_cast<unsigned char>(*p)] |= CC_SIGIL;
+    }
+    for (const char* p = extra_ident; *p; ++p) {
+        table[static_cast<unsigned char>(*p)] |= CC_IDENT;
+    }
+    return table;
+}
+
+template <size_t N>
+constexpr bool isSorted(const std::array<std::string_view, N>& words) {
+    for (size_t i = 1; i < N; ++i) {
+        if (!(words[i - 1] < words[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Keyword tables must stay sorted: lookups use binary search
+constexpr std::array<std::string_view, 84> cpp_keywords = {
+    "alignas", "alignof", "asm", "auto", "bool", "break", "case", "catch",
+    "char", "char16_t", "char32_t", "char8_t", "class", "co_await", "co_return",
+    "co_yield", "concept", "const", "const_cast", "consteval", "constexpr",
+    "constinit", "continue", "decltype", "default", "delete", "do", "double",
+    "dynamic_cast", "else", "enum", "explicit", "export", "extern", "final",
+    "float", "for", "friend", "goto", "if", "inline", "int", "int16_t",
+    "int32_t", "int64_t", "long", "mutable", "namespace", "new", "noexcept",
+    "operator", "override", "private", "protected", "public", "register",
+    "reinterpret_cast", "requires", "return", "short", "signed", "size_t",
+    "sizeof", "static", "static_assert", "static_cast", "struct", "switch",
+    "template", "this", "thread_local", "throw", "try", "typedef", "typeid",
+    "typename", "union", "unsigned", "using", "virtual", "void", "volatile",
+    "wchar_t", "while"
+};
+
+constexpr std::array<std::string_view, 3> cpp_literals = {
+    "false", "nullptr", "true"
+};
+
+constexpr std::array<std::string_view, 35> python_keywords = {
+    "and", "as", "assert", "async", "await", "break", "case", "class",
+    "continue", "def", "del", "elif", "else", "except", "finally", "for",
+    "from", "global", "if", "import", "in", "is", "lambda", "match", "nonlocal",
+    "not", "or", "pass", "raise", "return", "self", "try", "while", "with",
+    "yield"
+};
+
+constexpr std::array<std::string_view, 3> python_literals = {
+    "False", "None", "True"
+};
+
+constexpr std::array<std::string_view, 0> json_keywords = {};
+
+constexpr std::array<std::string_view, 3> json_literals = {
+    "false", "null", "true"
+};
+
+constexpr std::array<std::string_view, 28> shell_keywords = {
+    "alias", "case", "cd", "declare", "do", "done", "echo", "elif", "else",
+    "esac", "eval", "exec", "exit", "export", "fi", "for", "function", "if",
+    "in", "local", "read", "readonly", "return", "set", "shift", "source",
+    "then", "while"
+};
+
+constexpr std::array<std::string_view, 2> shell_literals = {
+    "false", "true"
+};
+
+// Per-language lexer description
+struct LanguageSpec {
+    CharTable chars;
+    const std::string_view* keywords;
+    size_t keyword_count;
+    const std::string_view* literals;
+    size_t literal_count;
+    std::string_view line_comment;       // Empty if the language has none
+    std::string_view block_open;         // Empty if the language has none
+    std::string_view block_close;
+    bool triple_quotes;                  // Python """...""" strings
+    bool object_keys;                    // JSON strings followed by ':' are keys
+    bool word_start_comments;            // Shell '#' only opens a comment at a word start
+    bool signed_numbers;                 // JSON '-' before a digit belongs to the number
+    bool raw_single_quotes;              // Shell '...' strings have no backslash escapes
+    bool digit_separators;               // C++14 ' between digits, as in 1'000
+};
+
+constexpr LanguageSpec cpp_spec = {
+    buildCharTable("\"'", "/", "#", ""),
+    cpp_keywords.data(), cpp_keywords.size(),
+    cpp_literals.data(), cpp_literals.size(),
+    "//", "/*", "*/", false, false, false, false, false, true
+};
+
+constexpr LanguageSpec python_spec = {
+    buildCharTable("\"'", "#", "", ""),
+    python_keywords.data(), python_keywords.size(),
+    python_literals.data(), python_literals.size(),
+    "#", "", "", true, false, false, false, false, false
+};
+
+constexpr LanguageSpec json_spec = {
+    buildCharTable("\"", "", "", ""),
+    json_keywords.data(), json_keywords.size(),
+    json_literals.data(), json_literals.size(),
+    "", "", "", false, true, false, true, false, false
+};
+
+constexpr LanguageSpec shell_spec = {
+    buildCharTable("\"'", "#", "$", "-"),
+    shell_keywords.data(), shell_keywords.size(),
+    shell_literals.data(), shell_literals.size(),
+    "#", "", "", false, false, true, false, true, false
+};
+
+bool containsWord(const std::string_view* words, size_t count, std::string_view word) {
+    return std::binary_search(words, words + count, word);
+}
+
+const LanguageSpec* specFor(HighlightLanguage language) {
+    switch (language) {
+        case HighlightLanguage::CPP:    return &cpp_spec;
+        case HighlightLanguage::PYTHON: return &python_spec;
+        case HighlightLanguage::JSON:   return &json_spec;
+        case HighlightLanguage::SHELL:  return &shell_spec;
+        default:                        return nullptr;
+    }
+}
+
+// Returns the position just past the string literal starting at 'start'
+size_t scanString(const LanguageSpec& spec, const std::string& code, size_t start) {
+    const size_t n = code.size();
+    const char quote = code[start];
+
+    if (spec.triple_quotes && start + 2 < n && code[start + 1] == quote && code[start + 2] == quote) {
+        size_t close = code.find(std::string(3, quote), start + 3);
+        return close == std::string::npos ? n : close + 3;
+    }
+
+    const bool escapes = !(spec.raw_single_quotes && quote == '\'');
+    size_t i = start + 1;
+    while (i < n && code[i] != quote && code[i] != '\n') {
+        i += (escapes && code[i] == '\\' && i + 1 < n) ? 2 : 1;
+    }
+    return (i < n && code[i] == quote) ? i + 1 : i;
+}
+
+} // namespace
+
+// Static assertions keep the binary searches honest when tables are edited
+static_assert(isSorted(cpp_keywords) && isSorted(cpp_literals) &&
+              isSorted(python_keywords) && isSorted(python_literals) &&
+              isSorted(json_literals) && isSorted(shell_keywords) &&
+              isSorted(shell_literals), "highlighter word tables must be sorted");
+
+HighlightLanguage Highlighter::languageFromName(const std::string& name) {
+    static const std::pair<const char*, HighlightLanguage> aliases[] = {
+        {"cpp", HighlightLanguage::CPP},
+        {"cxx", HighlightLanguage::CPP},
+        {"cc", HighlightLanguage::CPP},
+        {"c", HighlightLanguage::CPP},
+        {"hpp", HighlightLanguage::CPP},
+        {"h", HighlightLanguage::CPP},
+        {"python", HighlightLanguage::PYTHON},
+        {"python3", HighlightLanguage::PYTHON},
+        {"py", HighlightLanguage::PYTHON},
+        {"json", HighlightLanguage::JSON},
+        {"sh", HighlightLanguage::SHELL},
+        {"bash", HighlightLanguage::SHELL},
+        {"shell", HighlightLanguage::SHELL},
+        {"zsh", HighlightLanguage::SHELL}
+    };
+
+    for (const auto& alias : aliases) {
+        if (name == alias.first) {
+            return alias.second;
+        }
+    }
+    return HighlightLanguage::NONE;
+}
+
+void Highlighter::highlight(HighlightLanguage language, const std::string& code, std::string& out) const {
+    const LanguageSpec* spec = specFor(language);
+    if (!spec) {
+        appendEscapedHTML(out, code, 0, code.size());
+        return;
+    }
+
+    const size_t n = code.size();
+    size_t plain_start = 0; // Start of the pending run of unhighlighted text
+    size_t i = 0;
+    bool line_start = true;
+
+    // Wrap code[begin, end) in a span, flushing any pending plain text first
+    auto emit = [&](const char* css_class, size_t begin, size_t end) {
+        if (begin > plain_start) {
+            appendEscapedHTML(out, code, plain_start, begin);
+        }
+        out += "<span class=\"";
+        out += css_class;
+        out += "\">";
+        appendEscapedHTML(out, code, begin, end);
+        out += "</span>";
+        plain_start = end;
+    };
+
+    auto matchesAt = [&](size_t pos, std::string_view text) {
+        return !text.empty() && code.compare(pos, text.size(), text.data(), text.size()) == 0;
+    };
+
+    while (i < n) {
+        const unsigned char c = static_cast<unsigned char>(code[i]);
+        const unsigned char cls = spec->chars[c];
+        const size_t start = i;
+
+        if (cls & CC_SPACE) {
+            line_start = line_start || c == '\n';
+            ++i;
+            continue;
+        }
+
+        const bool at_line_start = line_start;
+        line_start = false;
+
+        // Comments
+        if (cls & CC_COMMENT) {
+            const bool word_start = i == 0 || (spec->chars[static_cast<unsigned char>(code[i - 1])] & CC_SPACE);
+            if (matchesAt(i, spec->line_comment) && (word_start || !spec->word_start_comments)) {
+                i = std::min(code.find('\n', i), n);
+                emit("hl-com", start, i);
+                continue;
+            }
+            if (matchesAt(i, spec->block_open)) {
+                size_t close = code.find(spec->block_close.data(), i + spec->block_open.size(),
+                                         spec->block_close.size());
+                i = close == std::string::npos ? n : close + spec->block_close.size();
+                emit("hl-com", start, i);
+                continue;
+            }
+        }
+
+        // Preprocessor directives and shell variables
+        if (cls & CC_SIGIL) {
+            if (c == '#' && at_line_start) {
+                i = std::min(code.find('\n', i), n);
+                emit("hl-pre", start, i);
+                continue;
+            }
+            // Anything else after '$', such as the $(...) and $((...))
+            // substitutions, is left plain so its contents highlight normally
+            if (c == '$' && i + 1 < n) {
+                const char next = code[i + 1];
+                const bool special = std::isdigit(static_cast<unsigned char>(next)) ||
+                                     std::string_view("?@*#$!-").find(next) != std::string_view::npos;
+                if (next == '{') {
+                    size_t close = code.find('}', i + 2);
+                    i = close == std::string::npos ? n : close + 1;
+                } else if (spec->chars[static_cast<unsigned char>(code[i + 1])] & CC_IDENT_START) {
+                    i += 2;
+                    while (i < n && (spec->chars[static_cast<unsigned char>(code[i])] & (CC_IDENT_START | CC_DIGIT))) {
+                        ++i;
+                    }
+                } else if (special) {
+                    i += 2; // Special parameters such as $?, $@ or $1
+                }
+                if (i > start) {
+                    emit("hl-var", start, i);
+                    continue;
+                }
+            }
+        }
+
+        // String literals
+        if (cls & CC_QUOTE) {
+            i = scanString(*spec, code, start);
+            const char* css_class = "hl-str";
+            if (spec->object_keys) {
+                size_t next = code.find_first_not_of(" \t\r\n", i);
+                if (next != std::string::npos && code[next] == ':') {
+                    css_class = "hl-key";
+                }
+            }
+            emit(css_class, start, i);
+            continue;
+        }
+
+        // Numbers, including suffixes, hex digits, decimal points and signed exponents
+        const bool negative = spec->signed_numbers && c == '-' && i + 1 < n &&
+                              (spec->chars[static_cast<unsigned char>(code[i + 1])] & CC_DIGIT);
+        if ((cls & CC_DIGIT) || negative) {
+            const size_t digits = negative ? start + 1 : start;
+            const bool hex = digits + 1 < n && code[digits] == '0' && (code[digits + 1] == 'x' || code[digits + 1] == 'X');
+            i = digits;
+            while (i < n) {
+                const char d = code[i];
+                if ((spec->chars[static_cast<unsigned char>(d)] & CC_IDENT) || d == '.') {
+                    ++i;
+                } else if ((d == '+' || d == '-') && !hex && (code[i - 1] == 'e' || code[i - 1] == 'E')) {
+                    ++i;
+                } else if (d == '\'' && spec->digit_separators && i + 1 < n &&
+                           std::isxdigit(static_cast<unsigned char>(code[i - 1])) &&
+                           std::isxdigit(static_cast<unsigned char>(code[i + 1]))) {
+                    ++i;
+                } else {
+                    break;
+                }
+            }
+            emit("hl-num", start, i);
+            continue;
+        }
+
+        // Identifiers, keywords and literal constants
+        if (cls & CC_IDENT_START) {
+            while (i < n && (spec->chars[static_cast<unsigned char>(code[i])] & CC_IDENT)) {
+                ++i;
+            }
+            std::string_view word(code.data() + start, i - start);
+            if (containsWord(spec->keywords, spec->keyword_count, word)) {
+                emit("hl-kw", start, i);
+            } else if (containsWord(spec->literals, spec->literal_count, word)) {
+                emit("hl-lit", start, i);
+            }
+            continue;
+        }
+
+        ++i;
+    }
+
+    if (n > plain_start) {
+        appendEscapedHTML(out, code, plain_start, n);
+    }
+}
@@ -2,7 +2,7 @@
 #include <iostream>
 #include <algorithm>
 
-Lexer::Lexer() : current_line(0), current_pos(0) {
+Lexer::Lexer() : current_line(0), current_pos(0), in_code_block(false) {
     // Initialize regex patterns
     header_pattern = std::regex(R"(^(#{1,6})\s+(.+)$)");
     list_pattern = std::regex(R"(^[\s]*[-*+]\s+(.+)$)");
@@ -19,6 +19,7 @@ void Lexer::setInput(const std::vector<std::string>& input_lines) {
     lines = input_lines;
     current_line = 0;
     current_pos = 0;
+    in_code_block = false;
 }
 
 Token Lexer::getNextToken() {
@@ -36,6 +37,15 @@ Token Lexer::getNextToken() {
     
     // Classify the line type
     TokenType type = classifyLine(line);
+    
+    // Keep code block content intact so markers like '#' or '-' survive
+    if (type == TokenType::CODE_BLOCK) {
+        in_code_block = !in_code_block;
+    } else if (in_code_block) {
+        current_line++;
+        return Token(TokenType::TEXT, line, current_line - 1);
+    }
+
     std::string value = line;
     std::smatch match; // Declare before switch to avoid jump errors
     // Extract specific content based on type
@@ -68,6 +78,7 @@ bool Lexer::hasMoreTokens() const {
 void Lexer::reset() {
     current_line = 0;
     current_pos = 0;
+    in_code_block = false;
 }
 
 TokenType Lexer::classifyLine(const std::string& line) {
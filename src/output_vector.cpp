@@ -0,0 +1,158 @@
+#include "transpiler.hpp"
+#include <iostream>
+#include <fstream>
+#include <cerrno>
+#include <cstring>
+#include <climits>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/uio.h>
+#endif
+
+// Maximum number of entries handed to a single writev call
+#ifdef IOV_MAX
+static const size_t WRITEV_BATCH_SIZE = IOV_MAX;
+#else
+static const size_t WRITEV_BATCH_SIZE = 1024;
+#endif
+
+OutputVector::OutputVector() : chunk(nullptr), total_size(0) {}
+
+void OutputVector::append(const char* data, size_t length) {
+    if (length == 0) {
+        return;
+    }
+    if (length < COPY_THRESHOLD) {
+        copyIntoChunk(data, length);
+        return;
+    }
+    entries.push_back({data, length});
+    total_size += length;
+}
+
+void OutputVector::append(const std::string& text) {
+    append(text.data(), text.size());
+}
+
+void OutputVector::appendOwned(std::string text) {
+    if (text.size() < COPY_THRESHOLD) {
+        copyIntoChunk(text.data(), text.size());
+        return;
+    }
+    owned.push_back(std::move(text));
+    append(owned.back());
+}
+
+void OutputVector::reset() {
+    entries.clear();
+    owned.clear();
+    chunk = nullptr;
+    total_size = 0;
+}
+
+void OutputVector::copyIntoChunk(const char* data, size_t length) {
+    if (length == 0) {
+        return;
+    }
+    
+    // Chunks never grow past their reserved capacity, so entries into them stay valid
+    if (!chunk || chunk->size() + length > chunk->capacity()) {
+        owned.emplace_back();
+        chunk = &owned.back();
+        chunk->reserve(CHUNK_SIZE);
+    }
+    
+    const char* end = chunk->data() + chunk->size();
+    chunk->append(data, length);
+    
+    // Extend the previous entry when it is this chunk's tail
+    if (end != chunk->data() && !entries.empty() && entries.back().data + entries.back().length == end) {
+        entries.back().length += length;
+    } else {
+        entries.push_back({end, length});
+    }
+    total_size += length;
+}
+
+#ifdef _WIN32
+
+bool writeToFile(const std::string& filename, const OutputVector& output) {
+    std::ofstream file(filename, std::ios::binary);
+    
+    if (!file.is_open()) {
+        std::cerr << "Error: Could not create output file '" << filename << "'" << std::endl;
+        return false;
+    }
+    
+    for (const auto& entry : output.getEntries()) {
+        file.write(entry.data, entry.length);
+    }
+    file.close();
+    
+    if (!file) {
+        std::cerr << "Error: Could not write output file '" << filename << "'" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+#else
+
+bool writeToFile(const std::string& filename, const OutputVector& output) {
+    int fd = open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    
+    if (fd < 0) {
+        std::cerr << "Error: Could not create output file '" << filename << "'" << std::endl;
+        return false;
+    }
+    
+    const auto& entries = output.getEntries();
+    struct iovec batch[WRITEV_BATCH_SIZE];
+    size_t index = 0;   // First entry not yet fully written
+    size_t offset = 0;  // Bytes of entries[index] already written
+    
+    while (index < entries.size()) {
+        int count = 0;
+        for (size_t i = index; i < entries.size() && count < static_cast<int>(WRITEV_BATCH_SIZE); ++i, ++count) {
+            size_t skip = (i == index) ? offset : 0;
+            batch[count].iov_base = const_cast<char*>(entries[i].data + skip);
+            batch[count].iov_len = entries[i].length - skip;
+        }
+        
+        ssize_t written = writev(fd, batch, count);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            std::cerr << "Error: Could not write output file '" << filename << "': "
+                      << std::strerror(errno) << std::endl;
+            close(fd);
+            return false;
+        }
+        
+        // Advance past everything the kernel accepted, which may end mid-entry
+        size_t remaining = static_cast<size_t>(written);
+        while (remaining > 0 && index < entries.size()) {
+            size_t available = entries[index].length - offset;
+            if (remaining >= available) {
+                remaining -= available;
+                ++index;
+                offset = 0;
+            } else {
+                offset += remaining;
+                remaining = 0;
+            }
+        }
+    }
+    
+    if (close(fd) < 0) {
+        std::cerr << "Error: Could not write output file '" << filename << "': "
+                  << std::strerror(errno) << std::endl;
+        return false;
+    }
+    return true;
+}
+
+#endif
@@ -2,7 +2,7 @@
 #include <iostream>
 #include <algorithm>
 
-Parser::Parser() : current_token(0) {}
+Parser::Parser() : current_token(0), heading_count(0) {}
 
 void Parser::setTokens(const std::vector<Token>& token_list) {
     tokens = token_list;
@@ -11,6 +11,8 @@ void Parser::setTokens(const std::vector<Token>& token_list) {
 
 std::shared_ptr<Element> Parser::parse() {
     auto root = std::make_shared<Element>("div", "");
+    used_ids.clear();
+    heading_count = 0;
     
     while (!isAtEnd()) {
         auto block = parseBlock();
@@ -81,6 +83,10 @@ std::shared_ptr<Element> Parser::parseHeader() {
     std::string tag = "h" + std::to_string(level);
     auto element = std::make_shared<Element>(tag, "");
     
+    // Plain text for the page title and TOC, and a unique anchor for TOC links
+    element->plain_text = stripInlineMarkup(header_text);
+    element->id = uniqueHeadingId(element->plain_text);
+    
     // Parse inline elements within the header
     auto inline_element = parseInlineElements(header_text);
     if (inline_element) {
@@ -156,7 +162,10 @@ std::shared_ptr<Element> Parser::parseParagraph() {
 }
 
 std::shared_ptr<Element> Parser::parseCodeBlock() {
-    consume(); // Consume the opening ```
+    Token opening = consume(); // Consume the opening ```
+    
+    // The info string after the fence names the language, e.g. ```cpp
+    std::string language = trim(opening.value).substr(3);
     
     std::string code_content = "";
     
@@ -178,6 +187,9 @@ std::shared_ptr<Element> Parser::parseCodeBlock() {
     
     auto code_block = std::make_shared<Element>("pre", "");
     auto code_element = std::make_shared<Element>("code", code_content);
+    if (!language.empty()) {
+        code_element->addAttribute("class=\"language-" + language + "\"");
+    }
     code_block->addChild(code_element);
     
     return code_block;
@@ -224,6 +236,42 @@ std::shared_ptr<Element> Parser::parseInlineElements(const std::string& text) {
     return nullptr;
 }
 
+std::string Parser::stripInlineMarkup(const std::string& text) {
+    // Mirrors parseInlineElements, keeping only the visible text
+    static const std::regex image_regex(R"(!\[([^\]]*)\]\(([^)]+)\))");
+    static const std::regex link_regex(R"(\[([^\]]+)\]\(([^)]+)\))");
+    static const std::regex bold_regex(R"(\*\*(.+?)\*\*)");
+    static const std::regex italic_regex(R"(\*(.+?)\*|_(.+?)_)");
+    static const std::regex code_regex(R"(`([^`]+)`)");
+    
+    std::string plain = text;
+    plain = std::regex_replace(plain, image_regex, "$1");
+    plain = std::regex_replace(plain, link_regex, "$1");
+    plain = std::regex_replace(plain, bold_regex, "$1");
+    plain = std::regex_replace(plain, italic_regex, "$1$2");
+    plain = std::regex_replace(plain, code_regex, "$1");
+    return plain;
+}
+
+std::string Parser::uniqueHeadingId(const std::string& text) {
+    heading_count++;
+    
+    // Headings without ASCII letters or digits fall back to their position
+    std::string base = slugify(text);
+    if (base.empty()) {
+        base = "section-" + std::to_string(heading_count);
+    }
+    
+    // Repeated headings get -1, -2, ... suffixes
+    std::string id = base;
+    for (int suffix = 1; used_ids.count(id) > 0; ++suffix) {
+        id = base + "-" + std::to_string(suffix);
+    }
+    used_ids.insert(id);
+    
+    return id;
+}
+
 Token Parser::peek() const {
     if (current_token >= tokens.size()) {
         return Token(TokenType::END_OF_FILE, "", 0);
@@ -0,0 +1,148 @@
+#include "transpiler.hpp"
+#include <iostream>
+
+// Document shell used when no --template is given
+static const char DEFAULT_TEMPLATE[] =
+    "<!DOCTYPE html>\n"
+    "<html lang=\"en\">\n"
+    "<head>\n"
+    "    <meta charset=\"UTF-8\">\n"
+    "    <meta name=\"viewport\" content=\"width=device-width, initial-scale=1.0\">\n"
+    "    <title>{{title}}</title>\n"
+    "    <style>\n"
+    "{{css}}"
+    "    </style>\n"
+    "</head>\n"
+    "<body>\n"
+    "{{body}}\n"
+    "</body>\n"
+    "</html>\n";
+
+// Stylesheet used when no --css is given
+static const char DEFAULT_CSS[] =
+    "        body { font-family: Arial, sans-serif; line-height: 1.6; margin: 40px; }\n"
+    "        h1, h2, h3, h4, h5, h6 { color: #333; }\n"
+    "        code { background-color: #f4f4f4; padding: 2px 4px; border-radius: 3px; }\n"
+    "        pre { background-color: #f4f4f4; padding: 10px; border-radius: 5px; overflow-x: auto; }\n"
+    "        ul, ol { padding-left: 20px; }\n"
+    "        hr { border: none; border-top: 1px solid #ccc; margin: 20px 0; }\n"
+    "        .hl-kw { color: #0033b3; font-weight: bold; }\n"
+    "        .hl-str { color: #067d17; }\n"
+    "        .hl-key { color: #871094; }\n"
+    "        .hl-num, .hl-lit { color: #1750eb; }\n"
+    "        .hl-com { color: #8c8c8c; font-style: italic; }\n"
+    "        .hl-pre { color: #9e880d; }\n"
+    "        .hl-var { color: #b05a00; }\n";
+
+PageTemplate::PageTemplate() {
+    compile(DEFAULT_TEMPLATE);
+}
+
+bool PageTemplate::compile(const std::string& source) {
+    segments.clear();
+    
+    size_t pos = 0;
+    while (pos < source.length()) {
+        size_t open = source.find("{{", pos);
+        if (open == std::string::npos) {
+            addLiteral(source.substr(pos));
+            break;
+        }
+        
+        size_t close = source.find("}}", open + 2);
+        if (close == std::string::npos) {
+            std::cerr << "Error: Unterminated template slot at offset " << open << std::endl;
+            segments.clear();
+            return false;
+        }
+        
+        std::string name = trim(source.substr(open + 2, close - open - 2));
+        Slot slot;
+        if (!slotFromName(name, slot)) {
+            std::cerr << "Error: Unknown template slot '{{" << name << "}}'" << std::endl;
+            segments.clear();
+            return false;
+        }
+        
+        addLiteral(source.substr(pos, open - pos));
+        segments.emplace_back(slot);
+        pos = close + 2;
+    }
+    
+    if (!hasSlot(Slot::BODY)) {
+        std::cerr << "Error: Template has no {{body}} slot" << std::endl;
+        segments.clear();
+        return false;
+    }
+    
+    return true;
+}
+
+bool PageTemplate::loadFromFile(const std::string& filename) {
+    std::string source;
+    if (!readFileContents(filename, source)) {
+        return false;
+    }
+    return compile(source);
+}
+
+bool PageTemplate::hasSlot(Slot slot) const {
+    for (const auto& segment : segments) {
+        if (segment.slot == slot) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void PageTemplate::render(const PageContent& content, Generator& generator, OutputVector& out) const {
+    for (const auto& segment : segments) {
+        switch (segment.slot) {
+            case Slot::NONE:
+                out.append(segment.text);
+                break;
+            case Slot::TITLE: {
+                std::string title;
+                appendEscapedHTML(title, content.title, 0, content.title.length());
+                out.appendOwned(std::move(title));
+                break;
+            }
+            case Slot::CSS:
+                out.append(content.css);
+                break;
+            case Slot::TOC:
+                out.append(content.toc);
+                break;
+            case Slot::BODY:
+                if (content.body) {
+                    generator.generateHTML(*content.body, out);
+                }
+                break;
+        }
+    }
+}
+
+const char* PageTemplate::defaultCSS() {
+    return DEFAULT_CSS;
+}
+
+void PageTemplate::addLiteral(const std::string& text) {
+    if (!text.empty()) {
+        segments.emplace_back(Slot::NONE, text);
+    }
+}
+
+bool PageTemplate::slotFromName(const std::string& name, Slot& slot) {
+    if (name == "title") {
+        slot = Slot::TITLE;
+    } else if (name == "css") {
+        slot = Slot::CSS;
+    } else if (name == "toc") {
+        slot = Slot::TOC;
+    } else if (name == "body") {
+        slot = Slot::BODY;
+    } else {
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,95 @@
+#include "transpiler.hpp"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <cctype>
+
+// Utility function implementations
+std::vector<std::string> readLinesFromFile(const std::string& filename) {
+    std::vector<std::string> lines;
+    std::ifstream file(filename);
+    
+    if (!file.is_open()) {
+        std::cerr << "Error: Could not open file '" << filename << "'" << std::endl;
+        return lines;
+    }
+    
+    std::string line;
+    while (std::getline(file, line)) {
+        lines.push_back(line);
+    }
+    
+    file.close();
+    return lines;
+}
+
+bool readFileContents(const std::string& filename, std::string& content) {
+    std::ifstream file(filename);
+    
+    if (!file.is_open()) {
+        std::cerr << "Error: Could not open file '" << filename << "'" << std::endl;
+        return false;
+    }
+    
+    std::ostringstream buffer;
+    buffer << file.rdbuf();
+    content = buffer.str();
+    
+    file.close();
+    return true;
+}
+
+bool writeToFile(const std::string& filename, const std::string& content) {
+    std::ofstream file(filename);
+    
+    if (!file.is_open()) {
+        std::cerr << "Error: Could not create output file '" << filename << "'" << std::endl;
+        return false;
+    }
+    
+    file << content;
+    file.close();
+    
+    if (!file) {
+        std::cerr << "Error: Could not write output file '" << filename << "'" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+std::string trim(const std::string& str) {
+    size_t start = str.find_first_not_of(" \t\r\n");
+    if (start == std::string::npos) {
+        return "";
+    }
+    
+    size_t end = str.find_last_not_of(" \t\r\n");
+    return str.substr(start, end - start + 1);
+}
+
+bool startsWith(const std::string& str, const std::string& prefix) {
+    if (str.length() < prefix.length()) {
+        return false;
+    }
+    return str.substr(0, prefix.length()) == prefix;
+}
+
+std::string slugify(const std::string& text) {
+    std::string slug;
+    bool pending_dash = false;
+    
+    for (char c : text) {
+        unsigned char uc = static_cast<unsigned char>(c);
+        if (std::isalnum(uc)) {
+            if (pending_dash && !slug.empty()) {
+                slug += '-';
+            }
+            slug += static_cast<char>(std::tolower(uc));
+            pending_dash = false;
+        } else if (c == ' ' || c == '-' || c == '_') {
+            pending_dash = true;
+        }
+    }
+    
+    return slug;
+}